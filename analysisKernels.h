@@ -0,0 +1,236 @@
+#ifndef ANALYSIS_KERNELS_H
+#define ANALYSIS_KERNELS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Kinematics and classification kernels of the analysis stage, working on particle columns of a batch of events.
+// Free of ROOT and art so benchmarkKernels.C can build them with a plain compiler; the macros get them compiled
+// when run through ACLiC (e.g. `root 'convertRootToAnalysis.C+(...)'`).
+
+// Visibility class of a PDG code; each class has one energy threshold. Scoped, as ROOT's TPDGCode.h already
+// declares a global kProton.
+enum class ParticleClass : unsigned char {
+    kAlwaysVisible = 0,
+    kInvisible,      // Neutrinos, neutrons and nuclei
+    kChargedPion,    // E > 0.1 GeV
+    kProton,         // E > 0.05 GeV
+    kEMOrMuon        // Photons, electrons and muons, E > 0.03 GeV
+};
+const double kClassEnergyThresholds[] = {0.0, 0.0, 0.1, 0.05, 0.03};
+
+// PDG codes with |code| <= kPdgTableRange are classified by table lookup
+const int kPdgTableRange = 2212;
+
+struct PdgClassTable {
+    ParticleClass classes[2 * kPdgTableRange + 1];
+
+    PdgClassTable() {
+        std::fill(classes, classes + 2 * kPdgTableRange + 1, ParticleClass::kAlwaysVisible);
+        for (int code : {-12, -14, -16, 12, 14, 16, 2112}) set(code, ParticleClass::kInvisible);
+        for (int code : {211, -211}) set(code, ParticleClass::kChargedPion);
+        set(2212, ParticleClass::kProton);
+        for (int code : {22, 11, -11, 13, -13}) set(code, ParticleClass::kEMOrMuon);
+    }
+
+    void set(int pdgCode, ParticleClass particleClass) { classes[pdgCode + kPdgTableRange] = particleClass; }
+};
+
+inline const PdgClassTable& pdgClassTable() {
+    static const PdgClassTable table;
+    return table;
+}
+
+// Ten-character PDG codes (ions are 100ZZZAAAI), matching the string-length test of the old isNuclearCode
+inline bool isNuclearPdgCode(int pdgCode) {
+    return pdgCode >= 1000000000 || (pdgCode <= -100000000 && pdgCode >= -999999999);
+}
+
+inline ParticleClass particleClass(const PdgClassTable& table, int pdgCode) {
+    if (pdgCode >= -kPdgTableRange && pdgCode <= kPdgTableRange) return table.classes[pdgCode + kPdgTableRange];
+    return isNuclearPdgCode(pdgCode) ? ParticleClass::kInvisible : ParticleClass::kAlwaysVisible;
+}
+
+// Final-state (status 1 or 15) particles above their class threshold
+inline bool isVisibleParticle(const PdgClassTable& table, int pdgCode, int statusCode, double energy) {
+    ParticleClass c = particleClass(table, pdgCode);
+    bool finalState = (statusCode == 1) | (statusCode == 15);
+    return finalState & ((c == ParticleClass::kAlwaysVisible) |
+                         ((c != ParticleClass::kInvisible) & (energy > kClassEnergyThresholds[static_cast<int>(c)])));
+}
+
+inline bool isVisibleParticle(int pdgCode, int statusCode, double energy) {
+    return isVisibleParticle(pdgClassTable(), pdgCode, statusCode, energy);
+}
+
+// visible[i] = 1 for each visible particle of the n given
+inline void computeVisibilityMask(const int* pdgCodes, const int* statusCodes, const double* energies, size_t n, unsigned char* visible) {
+    const PdgClassTable& table = pdgClassTable();
+    for (size_t i = 0; i < n; i++) {
+        visible[i] = isVisibleParticle(table, pdgCodes[i], statusCodes[i], energies[i]);
+    }
+}
+
+// Tau decay mode from the PDG codes of the tau's daughters, in any order; -1 when unknown
+inline int tauDecayModeFromProducts(const int* products, size_t n) {
+    const size_t kMaxProducts = 5;
+    struct Signature {
+        size_t size;
+        int codes[kMaxProducts];  // Sorted ascending
+        int mode;
+    };
+    static const Signature signatures[] = {
+        {3, {-11, 12, 16}, 0},                // e- nu(e)~ nu(tau)
+        {3, {-13, 14, 16}, 1},                // mu- nu(mu)~ nu(tau)
+        {3, {-211, 16, 111}, 2},              // pi- pi0 nu(tau)
+        {2, {-211, 16}, 3},                   // pi- nu(tau)
+        {4, {-211, 16, 111, 111}, 4},         // pi- pi0 pi0 nu(tau)
+        {4, {-211, -211, 16, 211}, 5},        // pi- pi- pi+ nu(tau)
+        {5, {-211, -211, 16, 111, 211}, 6}    // pi- pi- pi+ pi0 nu(tau)
+    };
+    if (n < 2 || n > kMaxProducts) return -1;
+
+    // Insertion sort, at most five products
+    int sorted[kMaxProducts];
+    for (size_t i = 0; i < n; i++) {
+        size_t j = i;
+        for (; j > 0 && sorted[j - 1] > products[i]; j--) sorted[j] = sorted[j - 1];
+        sorted[j] = products[i];
+    }
+    for (const auto& signature : signatures) {
+        if (signature.size == n && std::equal(sorted, sorted + n, signature.codes)) return signature.mode;
+    }
+    return -1;
+}
+
+// Particle columns of a batch of events; event e owns particles [offsets[e], offsets[e + 1])
+struct ParticleBatch {
+    std::vector<int> pdgCodes;
+    std::vector<int> statusCodes;
+    std::vector<double> momentumX;
+    std::vector<double> momentumY;
+    std::vector<double> momentumZ;
+    std::vector<double> energies;
+    std::vector<size_t> offsets = {0};
+
+    size_t events() const { return offsets.size() - 1; }
+    size_t particles() const { return pdgCodes.size(); }
+
+    void add(int pdgCode, int statusCode, double px, double py, double pz, double energy) {
+        pdgCodes.push_back(pdgCode);
+        statusCodes.push_back(statusCode);
+        momentumX.push_back(px);
+        momentumY.push_back(py);
+        momentumZ.push_back(pz);
+        energies.push_back(energy);
+    }
+
+    void endEvent() { offsets.push_back(pdgCodes.size()); }
+
+    void clear() {
+        pdgCodes.clear();
+        statusCodes.clear();
+        momentumX.clear();
+        momentumY.clear();
+        momentumZ.clear();
+        energies.clear();
+        offsets.assign(1, 0);
+    }
+};
+
+// Per-event analysis variables of a batch
+struct EventSummaries {
+    std::vector<int> lastParticleVisible;  // Visibility of the event's last particle, -1 for events without particles
+    std::vector<int> leptonCount;
+    std::vector<int> negPionCount;
+    std::vector<int> chargedPionCount;
+    std::vector<double> leadingPionEnergy;
+    std::vector<double> otherParticleEnergySum;
+    std::vector<double> missingMomentumX;
+    std::vector<double> missingMomentumY;
+    std::vector<double> missingMomentumZ;
+    std::vector<double> missingTransverseMomentum;
+    std::vector<unsigned char> visible;  // Per-particle visibility mask
+
+    void resize(size_t events, size_t particles) {
+        lastParticleVisible.resize(events);
+        leptonCount.resize(events);
+        negPionCount.resize(events);
+        chargedPionCount.resize(events);
+        leadingPionEnergy.resize(events);
+        otherParticleEnergySum.resize(events);
+        missingMomentumX.resize(events);
+        missingMomentumY.resize(events);
+        missingMomentumZ.resize(events);
+        missingTransverseMomentum.resize(events);
+        visible.resize(particles);
+    }
+};
+
+// Unit vector along (x, y, z)
+inline void unitVector(double x, double y, double z, double unit[3]) {
+    double magnitude = sqrt(x * x + y * y + z * z);
+    unit[0] = x / magnitude;
+    unit[1] = y / magnitude;
+    unit[2] = z / magnitude;
+}
+
+// |p - u (p . u)| for n vectors p and the unit vector u
+inline void transverseMagnitudes(const double* x, const double* y, const double* z, size_t n, const double unit[3], double* out) {
+    const double ux = unit[0], uy = unit[1], uz = unit[2];
+    for (size_t i = 0; i < n; i++) {
+        double projection = x[i] * ux + y[i] * uy + z[i] * uz;
+        double tx = x[i] - ux * projection;
+        double ty = y[i] - uy * projection;
+        double tz = z[i] - uz * projection;
+        out[i] = sqrt(tx * tx + ty * ty + tz * tz);
+    }
+}
+
+// Lepton and pion counts, leading pi- energy, remaining visible energy and missing pT along beamDirection.
+// Particles are visited in order and skipped ones contribute exact zeros, so results match a per-particle loop bit for bit.
+inline void summarizeEvents(const ParticleBatch& batch, const double beamDirection[3], EventSummaries& summaries) {
+    size_t nEvents = batch.events();
+    summaries.resize(nEvents, batch.particles());
+    const int* pdgCodes = batch.pdgCodes.data();
+    const double* energies = batch.energies.data();
+    const unsigned char* visible = summaries.visible.data();
+    computeVisibilityMask(pdgCodes, batch.statusCodes.data(), energies, batch.particles(), summaries.visible.data());
+
+    for (size_t e = 0; e < nEvents; e++) {
+        int leptons = 0, negPions = 0, chargedPions = 0;
+        double leading = 0.0, other = 0.0, mx = 0.0, my = 0.0, mz = 0.0;
+        for (size_t j = batch.offsets[e]; j < batch.offsets[e + 1]; j++) {
+            int pdgCode = pdgCodes[j];
+            bool isVisible = visible[j];
+            bool isNegPion = pdgCode == -211;
+            leptons += isVisible & ((pdgCode == 11) | (pdgCode == -11) | (pdgCode == 13) | (pdgCode == -13));
+            negPions += isVisible & isNegPion;
+            chargedPions += isVisible & ((pdgCode == 211) | isNegPion);
+
+            bool newLeading = isVisible & isNegPion & (energies[j] > leading);
+            other += isVisible ? (newLeading ? leading : energies[j]) : 0.0;
+            leading = newLeading ? energies[j] : leading;
+
+            mx -= isVisible ? batch.momentumX[j] : 0.0;
+            my -= isVisible ? batch.momentumY[j] : 0.0;
+            mz -= isVisible ? batch.momentumZ[j] : 0.0;
+        }
+        bool empty = batch.offsets[e] == batch.offsets[e + 1];
+        summaries.lastParticleVisible[e] = empty ? -1 : visible[batch.offsets[e + 1] - 1];
+        summaries.leptonCount[e] = leptons;
+        summaries.negPionCount[e] = negPions;
+        summaries.chargedPionCount[e] = chargedPions;
+        summaries.leadingPionEnergy[e] = leading;
+        summaries.otherParticleEnergySum[e] = other;
+        summaries.missingMomentumX[e] = mx;
+        summaries.missingMomentumY[e] = my;
+        summaries.missingMomentumZ[e] = mz;
+    }
+    transverseMagnitudes(summaries.missingMomentumX.data(), summaries.missingMomentumY.data(), summaries.missingMomentumZ.data(),
+                         nEvents, beamDirection, summaries.missingTransverseMomentum.data());
+}
+
+#endif
@@ -0,0 +1,23 @@
+import uproot
+
+
+def read_analysis_arrays(path, branches, library='ak'):
+    """Read branches from an analysis file, including files written with friendOutput.
+
+    Friend-mode files only hold the derived branches; any other branch is read from the NeutrinoData file
+    named by their 'FriendFile' entry, which has the same entries in the same order.
+    """
+    with uproot.open(path) as f:
+        tree = f['NeutrinoData']
+        stored = set(tree.keys())
+        local = [branch for branch in branches if branch in stored]
+        missing = [branch for branch in branches if branch not in stored]
+        arrays = tree.arrays(local, library=library)
+        friend_path = f['FriendFile'].member('fTitle') if missing else None
+
+    if missing:
+        with uproot.open(friend_path) as f:
+            friend_arrays = f['NeutrinoData'].arrays(missing, library=library)
+        for branch in missing:
+            arrays[branch] = friend_arrays[branch]
+    return arrays
@@ -0,0 +1,217 @@
+#ifndef ART_CONVERSION_H
+#define ART_CONVERSION_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <algorithm>
+#include <dirent.h>
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TSystem.h"
+
+// Input selection, output routing and sharding shared by convertArtToRoot.C and convertArtToRootReco.C
+
+// Helper function to gather .root file paths from a directory
+std::vector<std::string> gatherRootFilePaths(const std::string& directoryPath) {
+    std::vector<std::string> rootFilePaths;
+    DIR* dir;
+    struct dirent* entry;
+    if ((dir = opendir(directoryPath.c_str())) != NULL) {
+        while ((entry = readdir(dir)) != NULL) {
+            std::string fileName(entry->d_name);
+            if (fileName.find(".root", (fileName.length() - 5)) != std::string::npos) {
+                rootFilePaths.push_back(directoryPath + fileName);
+            }
+        }
+        closedir(dir);
+    } else {
+        std::cerr << "Could not open directory: " << directoryPath << std::endl;
+    }
+    std::sort(rootFilePaths.begin(), rootFilePaths.end()); // readdir order is arbitrary
+    return rootFilePaths;
+}
+
+// Convert the whole of text to an integer; false for empty text, trailing characters or overflow
+bool parseInteger(const std::string& text, long long& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    errno = 0;
+    value = strtoll(text.c_str(), &end, 10);
+    return errno == 0 && *end == '\0';
+}
+
+bool parseInteger(const std::string& text, int& value) {
+    long long wide;
+    if (!parseInteger(text, wide) || wide < INT_MIN || wide > INT_MAX) return false;
+    value = (int)wide;
+    return true;
+}
+
+// MCTruth records with this current type and flavor are written to outputFilePath
+struct Route {
+    int requiredCurrentType;
+    int requiredNeutrinoPdgCode;
+    std::string outputFilePath;
+    TFile* outputFile = nullptr;
+    TTree* dataTree = nullptr;
+
+    bool matches(int currentType, int neutrinoPdgCode) const {
+        return requiredCurrentType == currentType && requiredNeutrinoPdgCode == neutrinoPdgCode;
+    }
+};
+
+// Write and close every route's output, or with keep false close and remove them
+void writeRouteOutputs(std::vector<Route>& routes, bool keep = true) {
+    for (auto& route : routes) {
+        route.outputFile->cd();
+        if (keep) route.dataTree->Write();
+        route.outputFile->Close();
+        delete route.outputFile;
+        if (!keep) gSystem->Unlink(route.outputFilePath.c_str());
+    }
+}
+
+// Part of the input one job converts: "" for everything, "file:i/N" for the i-th of N contiguous slices of the
+// sorted file list, or "events:i/M" for art events [i*M, (i+1)*M). "events:i/M/N" names the shard count N, and
+// shard N-1 then runs to the end of the input so no event is dropped
+struct ShardSpec {
+    bool byEvents = false;
+    int index = -1;  // -1 when not sharded
+    long long size = 0;  // Shard count for file shards, events per shard for event shards
+    int count = 0;  // Shard count of event shards, 0 when not given
+
+    bool sharded() const { return index >= 0; }
+    // The last of a known number of event shards also takes the events past count * size
+    bool lastEventShard() const { return byEvents && count > 0 && index == count - 1; }
+};
+
+bool parseShardSpec(const std::string& spec, ShardSpec& shard) {
+    if (spec.empty()) return true;
+    size_t colon = spec.find(':');
+    size_t slash = spec.find('/');
+    std::string kind = spec.substr(0, colon);
+    if (colon == std::string::npos || slash == std::string::npos || slash < colon || (kind != "file" && kind != "events")) {
+        std::cerr << "Malformed shard specification: " << spec << std::endl;
+        return false;
+    }
+    shard.byEvents = (kind == "events");
+    size_t countSlash = spec.find('/', slash + 1);
+    std::string size = spec.substr(slash + 1, countSlash == std::string::npos ? std::string::npos : countSlash - slash - 1);
+    if ((countSlash != std::string::npos && !shard.byEvents) || !parseInteger(spec.substr(colon + 1, slash - colon - 1), shard.index) ||
+        !parseInteger(size, shard.size) || (countSlash != std::string::npos && !parseInteger(spec.substr(countSlash + 1), shard.count))) {
+        std::cerr << "Malformed shard specification: " << spec << std::endl;
+        return false;
+    }
+    if (shard.index < 0 || shard.size <= 0 || (!shard.byEvents && shard.index >= shard.size) ||
+        (countSlash != std::string::npos && (shard.count <= 0 || shard.index >= shard.count))) {
+        std::cerr << "Shard out of range: " << spec << std::endl;
+        return false;
+    }
+    if (shard.byEvents && shard.count == 0) {
+        std::cerr << "Warning: " << spec << " has no shard count, events past the last shard's range will not be converted" << std::endl;
+    }
+    return true;
+}
+
+// Keep this shard's slice of the sorted file list, so shards merged in order reproduce the unsharded output
+std::vector<std::string> selectShardFiles(const std::vector<std::string>& fileNames, const ShardSpec& shard) {
+    if (!shard.sharded() || shard.byEvents) return fileNames;
+    size_t first = fileNames.size() * shard.index / shard.size;
+    size_t last = fileNames.size() * (shard.index + 1) / shard.size;
+    return std::vector<std::string>(fileNames.begin() + first, fileNames.begin() + last);
+}
+
+// An event shard stops reading once eventNumber is past its range; the last of a known shard count never does
+bool eventShardDone(const ShardSpec& shard, long long eventNumber) {
+    return shard.byEvents && !shard.lastEventShard() && eventNumber >= (shard.index + 1) * shard.size;
+}
+
+// Events before an event shard's range are skipped without reading any product
+bool skipEventForShard(const ShardSpec& shard, long long eventNumber) {
+    return shard.byEvents && eventNumber < shard.index * shard.size;
+}
+
+// "out.root" becomes "out.shard007.root"; mergeShards.C collects these in shard order
+std::string shardOutputPath(const std::string& outputFilePath, const ShardSpec& shard) {
+    if (!shard.sharded()) return outputFilePath;
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".shard%03d", shard.index);
+    size_t extension = outputFilePath.rfind(".root");
+    if (extension == std::string::npos) return outputFilePath + suffix;
+    return outputFilePath.substr(0, extension) + suffix + ".root";
+}
+
+// Gather the art files of inputDirectory, keep this shard's slice and point every route at its shard output.
+// With fewer files than shards some slices are empty; they still write their shard files. False when the
+// directory has no art files.
+bool prepareShardRoutes(const std::string& inputDirectory, std::vector<Route>& routes, const ShardSpec& shard, std::vector<std::string>& fileNames) {
+    std::vector<std::string> allFileNames = gatherRootFilePaths(inputDirectory);
+    if (allFileNames.empty()) {
+        std::cerr << "No .root files found in the specified directory: " << inputDirectory << std::endl;
+        return false;
+    }
+    fileNames = selectShardFiles(allFileNames, shard);
+    if (fileNames.empty()) std::cout << "Shard " << shard.index << " has no input files, writing empty outputs" << std::endl;
+    for (auto& route : routes) {
+        route.outputFilePath = shardOutputPath(route.outputFilePath, shard);
+    }
+    return true;
+}
+
+// An empty file shard still writes its empty trees, so every shard index exists for mergeShards.C. True when
+// there was nothing to convert and the routes' outputs are written and closed.
+bool writeEmptyShard(const std::vector<std::string>& fileNames, std::vector<Route>& routes) {
+    if (!fileNames.empty()) return false;
+    writeRouteOutputs(routes);
+    return true;
+}
+
+// Parse a routing table such as "CC:12=nu_e_cc.root,NC:12=nu_e_nc.root" (current may also be 1 or 0)
+std::vector<Route> parseRoutingTable(const std::string& routingTable) {
+    std::vector<Route> routes;
+    std::stringstream table(routingTable);
+    std::string entry;
+    while (std::getline(table, entry, ',')) {
+        size_t colon = entry.find(':');
+        size_t equals = entry.find('=');
+        if (colon == std::string::npos || equals == std::string::npos || equals < colon) {
+            std::cerr << "Malformed routing entry: " << entry << std::endl;
+            return {};
+        }
+        std::string current = entry.substr(0, colon);
+        Route route;
+        if (current == "CC" || current == "1") route.requiredCurrentType = 1;
+        else if (current == "NC" || current == "0") route.requiredCurrentType = 0;
+        else {
+            std::cerr << "Unknown current type in routing entry: " << entry << std::endl;
+            return {};
+        }
+        if (!parseInteger(entry.substr(colon + 1, equals - colon - 1), route.requiredNeutrinoPdgCode)) {
+            std::cerr << "Malformed neutrino PDG code in routing entry: " << entry << std::endl;
+            return {};
+        }
+        route.outputFilePath = entry.substr(equals + 1);
+        // Each category and each output file may appear once; two RECREATEs of one file would corrupt it
+        for (const auto& other : routes) {
+            if (other.requiredCurrentType == route.requiredCurrentType && other.requiredNeutrinoPdgCode == route.requiredNeutrinoPdgCode) {
+                std::cerr << "Duplicate category in routing entry: " << entry << std::endl;
+                return {};
+            }
+            if (other.outputFilePath == route.outputFilePath) {
+                std::cerr << "Duplicate output path in routing entry: " << entry << std::endl;
+                return {};
+            }
+        }
+        routes.push_back(route);
+    }
+    return routes;
+}
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef NEUTRINO_DATA_SCHEMA_H
+#define NEUTRINO_DATA_SCHEMA_H
+
+// Largest particle count of a NeutrinoData entry in the flat schema, shared by its writer and readers
+const int kMaxFlatParticles = 1024;
+
+#endif
@@ -2,6 +2,7 @@ import uproot
 import matplotlib.pyplot as plt
 import numpy as np
 import awkward as ak
+from analysis_arrays import read_analysis_arrays
 
 # File paths and settings
 files = {
@@ -29,35 +30,33 @@ fig.suptitle('Distribution of Variables for Different Neutrino Interactions')
 
 # Processing each file
 for i, (label, path) in enumerate(files.items()):
-    with uproot.open(path) as f:
-        tree = f['NeutrinoData']
-        arrays = tree.arrays(filter_name=branches + ['ParticleEnergies', 'leptonCount', 'negPionCount', 'weight'], library='ak')
-        include_mask = (arrays['leptonCount'] == 0) & (arrays['negPionCount'] > 0)
+    arrays = read_analysis_arrays(path, branches + ['ParticleEnergies', 'leptonCount', 'negPionCount', 'weight'], library='ak')
+    include_mask = (arrays['leptonCount'] == 0) & (arrays['negPionCount'] > 0)
+    
+    # Use Awkward Array to handle jagged array of energies
+    initial_neutrino_energy = arrays['ParticleEnergies'][:, 0]  # Get the first energy for each event
+
+    weights = arrays['weight']
+    weights_filtered = arrays['weight'][include_mask]
+
+    # Plot each variable
+    plot_branches = ['initialNeutrinoEnergy'] + branches
+    for j, branch in enumerate(plot_branches):
+        if branch == 'initialNeutrinoEnergy':
+            data = initial_neutrino_energy
+            plot_weights = weights * 1.3 * 10**(-25)
+        else:
+            data = arrays[branch][include_mask]
+            plot_weights = weights_filtered * 1.3 * 10**(-25)
         
-        # Use Awkward Array to handle jagged array of energies
-        initial_neutrino_energy = arrays['ParticleEnergies'][:, 0]  # Get the first energy for each event
-
-        weights = arrays['weight']
-        weights_filtered = arrays['weight'][include_mask]
-
-        # Plot each variable
-        plot_branches = ['initialNeutrinoEnergy'] + branches
-        for j, branch in enumerate(plot_branches):
-            if branch == 'initialNeutrinoEnergy':
-                data = initial_neutrino_energy
-                plot_weights = weights * 1.3 * 10**(-25)
-            else:
-                data = arrays[branch][include_mask]
-                plot_weights = weights_filtered * 1.3 * 10**(-25)
-            
-            axs[j].hist(data, bins=bins.get(branch, 30), weights=plot_weights, color=colors[i], histtype="step", linewidth=1.5, label=f'{labels[i]}')
-            axs[j].set_xlabel(f"{titles[j]} [GeV]")
-            axs[j].set_ylabel('Events per POT kT Year')
-            if branch == 'initialNeutrinoEnergy':
-                axs[j].legend()
-            if branch in ["otherParticleEnergySum"]:
-                axs[j].set_xscale('log')
-                axs[j].set_yscale('log')
+        axs[j].hist(data, bins=bins.get(branch, 30), weights=plot_weights, color=colors[i], histtype="step", linewidth=1.5, label=f'{labels[i]}')
+        axs[j].set_xlabel(f"{titles[j]} [GeV]")
+        axs[j].set_ylabel('Events per POT kT Year')
+        if branch == 'initialNeutrinoEnergy':
+            axs[j].legend()
+        if branch in ["otherParticleEnergySum"]:
+            axs[j].set_xscale('log')
+            axs[j].set_yscale('log')
 
 plt.tight_layout(rect=[0, 0.03, 1, 0.95])
 plt.savefig("../nutau-data/plots/analysis-plots.svg")
@@ -2,6 +2,7 @@ import uproot
 import matplotlib.pyplot as plt
 import numpy as np
 import awkward as ak
+from analysis_arrays import read_analysis_arrays
 
 def plot_initial_neutrino_energy(files_data, output_filename):
     # Bins for the histogram of initial neutrino energy
@@ -15,18 +16,14 @@ def plot_initial_neutrino_energy(files_data, output_filename):
         
         # Processing each file
         for i, (label, path) in enumerate(files.items()):
-            with uproot.open(path) as f:
-                tree = f['NeutrinoData']
-                # Filtering based on 'include' branch
-                arrays = tree.arrays(filter_name=['ParticleEnergies', 'weight'], library='ak')
-                # Apply the filter 'include == 1'
-                initial_neutrino_energy = arrays['ParticleEnergies'][:, 0]  # First energy for each event after filtering
-                weights = arrays['weight'] * 1.3e-25  # Scaling factor
-
-                ax.hist(initial_neutrino_energy, bins=bins, weights=weights, color=colors[i], histtype="step", linewidth=1.5, label=f'{labels[i]}')
-                ax.set_xlabel('Initial Neutrino Energy [GeV]')
-                ax.set_ylabel('Events per POT kT Year')
-                ax.legend()
+            arrays = read_analysis_arrays(path, ['ParticleEnergies', 'weight'], library='ak')
+            initial_neutrino_energy = arrays['ParticleEnergies'][:, 0]  # First energy for each event
+            weights = arrays['weight'] * 1.3e-25  # Scaling factor
+
+            ax.hist(initial_neutrino_energy, bins=bins, weights=weights, color=colors[i], histtype="step", linewidth=1.5, label=f'{labels[i]}')
+            ax.set_xlabel('Initial Neutrino Energy [GeV]')
+            ax.set_ylabel('Events per POT kT Year')
+            ax.legend()
 
     plt.tight_layout()
     plt.savefig(f"../nutau-data/plots/{output_filename}")
@@ -0,0 +1,60 @@
+#!/bin/bash
+
+# Usage check
+if [ "$#" -lt 5 ]; then
+    echo "Usage: ./run-shards.sh <script_path> <command> <shard_count> <processes> <output_file>..."
+    echo "Runs <command> once per shard with {shard} replaced by the shard index, then merges each output file"
+    echo "Example: ./run-shards.sh ./batch-root.sh 'convertArtToRoot.C(\"../nutau-data/art/NuECC/\",\"../nutau-data/root/nu_e_cc.root\",1,12,\"vector\",-1,32000,\"file:{shard}/8\")' 8 8 ../nutau-data/root/nu_e_cc.root"
+    exit 1
+fi
+
+# Save inputs
+script_path="$1"
+command="$2"
+shard_count="$3"
+processes="$4"
+shift 4
+output_files=("$@")
+
+# Logs of each shard, next to the batch job logs
+logs_dir="./jobs/local/logs"
+mkdir -p "$logs_dir"
+
+# Remove shards of earlier runs, so a shard that fails before writing cannot leave stale data to merge
+for output_file in "${output_files[@]}"; do
+    rm -f -- "${output_file%.root}".shard*.root
+done
+
+# Run the shards in a pool of local processes
+export script_path command logs_dir
+seq 0 $((shard_count - 1)) | xargs -P "$processes" -I{} bash -c '
+    shard="$1"
+    shard_command="${command//\{shard\}/$shard}"
+    echo "Shard $shard: $shard_command"
+    "$script_path" "$shard_command" > "$logs_dir/shard-$shard.log" 2>&1 || { echo "Shard $shard failed, see $logs_dir/shard-$shard.log"; exit 1; }
+' _ {}
+if [ $? -ne 0 ]; then
+    echo "Not merging: at least one shard failed"
+    exit 1
+fi
+
+# ROOT exits 0 after most macro errors, so also require every shard file to exist
+missing=0
+for output_file in "${output_files[@]}"; do
+    for shard in $(seq 0 $((shard_count - 1))); do
+        shard_file=$(printf "%s.shard%03d.root" "${output_file%.root}" "$shard")
+        if [ ! -f "$shard_file" ]; then
+            echo "Missing $shard_file, see $logs_dir/shard-$shard.log"
+            missing=1
+        fi
+    done
+done
+if [ "$missing" -ne 0 ]; then
+    echo "Not merging: at least one shard wrote no output"
+    exit 1
+fi
+
+# Merge shards 0 to shard_count - 1 of each output in shard order
+for output_file in "${output_files[@]}"; do
+    "$script_path" "mergeShards.C(\"$output_file\",$shard_count)" || { echo "Merging $output_file failed"; exit 1; }
+done
@@ -0,0 +1,6 @@
+run=01
+
+# One pass over a directory mixing interaction types, writing every (current, flavor) category
+routes='CC:12=../nutau-data/root/nu_e_cc.root,NC:12=../nutau-data/root/nu_e_nc.root,CC:14=../nutau-data/root/nu_mu_cc.root,NC:14=../nutau-data/root/nu_mu_nc.root,CC:16=../nutau-data/root/nu_tau_cc.root,NC:16=../nutau-data/root/nu_tau_nc.root'
+
+./submit-job.sh ./batch-root.sh 'convertArtToRoot.C("../nutau-data/art/mixed/","'$routes'")' $run all convertArtToRoot
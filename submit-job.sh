@@ -1,8 +1,8 @@
 #!/bin/bash
 
 # Usage check
-if [ "$#" -ne 5 ]; then
-    echo "Usage: ./submit_job.sh <script_path> <command> <run_number> <event_type> <macro_name>"
+if [ "$#" -lt 5 ] || [ "$#" -gt 6 ]; then
+    echo "Usage: ./submit_job.sh <script_path> <command> <run_number> <event_type> <macro_name> [ncpus]"
     echo "Example: ./submit_job.sh my_root.sh 'artToRoot.C(\"../data/input/\",\"../data/output/output.root\")' 01 nu_e_cc artToRoot"
     exit 1
 fi
@@ -13,6 +13,7 @@ command="$2"
 run_number=$(printf "%02d" $3)  # Ensures the run number is two digits (01, 02, etc.)
 event_type="$4"
 macro_name="$5"
+ncpus="${6:-1}"
 
 # Main directory for job scripts and logs, organized by run number
 job_dir="./jobs/run-$run_number"
@@ -41,7 +42,7 @@ cat <<EOF >"$pbs_script"
 #PBS -j oe
 #PBS -o $logs_dir/$file_name-output.log
 #PBS -e $logs_dir/$file_name-error.log
-#PBS -l select=1:ncpus=1:mem=16gb
+#PBS -l select=1:ncpus=$ncpus:mem=16gb
 #PBS -l walltime=01:00:00
 
 # Change to the specified directory